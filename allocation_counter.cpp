@@ -0,0 +1,91 @@
+#include "allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* Allocate(std::size_t size) noexcept {
+  auto& stats = UniversalSerializeLibrary::allocationStats;
+  stats.allocations++;
+  stats.bytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+};
+
+void* Allocate(std::size_t size, std::align_val_t alignment) noexcept {
+  auto& stats = UniversalSerializeLibrary::allocationStats;
+  stats.allocations++;
+  stats.bytes += size;
+  const auto align = static_cast<std::size_t>(alignment);
+  return std::aligned_alloc(align, (size + align - 1) / align * align + (size == 0 ? align : 0));
+};
+
+void Deallocate(void* ptr) noexcept {
+  if(ptr) {
+    UniversalSerializeLibrary::allocationStats.deallocations++;
+    std::free(ptr);
+  };
+};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  if(auto* ptr = Allocate(size)) {
+    return ptr;
+  };
+  throw std::bad_alloc{};
+};
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+};
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+};
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+};
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if(auto* ptr = Allocate(size, alignment)) {
+    return ptr;
+  };
+  throw std::bad_alloc{};
+};
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+};
+
+void operator delete(void* ptr) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete[](void* ptr) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+};
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace UniversalSerializeLibrary {
+
+  struct AllocationStats {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t bytes = 0;
+    constexpr AllocationStats operator-(const AllocationStats& other) const noexcept {
+      return {this->allocations - other.allocations, this->deallocations - other.deallocations, this->bytes - other.bytes};
+    };
+  };
+
+  // Updated by the replaced global operator new/delete from allocation_counter.cpp
+  inline thread_local AllocationStats allocationStats{};
+
+  template <typename Func>
+  inline AllocationStats CountAllocations(Func&& func) {
+    const auto before = allocationStats;
+    if constexpr(std::is_void_v<std::invoke_result_t<Func>>) {
+      std::forward<Func>(func)();
+      return allocationStats - before;
+    } else {
+      [[maybe_unused]] const auto result = std::forward<Func>(func)();
+      return allocationStats - before;
+    };
+  };
+
+};
@@ -4,6 +4,7 @@
 #include <userver/utils/regex.hpp>
 #include <fmt/format.h>
 #include <map>
+#include <variant>
 
 USERVER_NAMESPACE_BEGIN
 namespace formats::universal::impl {
@@ -39,6 +40,19 @@ struct Pattern {
   static constexpr auto kValue = Regex;
 };
 
+template <utils::ConstexprString Name>
+struct Discriminator {
+  static constexpr auto kValue = Name;
+};
+
+// Enum<> takes the names from reflection, which only scans the values
+// [-128, 127]: enumerators outside that range are not found, so such enums
+// need Enum<"name", ...>. Serializing is an array index and parsing a
+// perfect-hash lookup, but the name is read with As<std::string>(), which
+// allocates for names longer than the small-string buffer
+template <utils::ConstexprString... Names>
+struct Enum {};
+
 template <auto... Checks>
 struct Items {
   static constexpr auto kChecks = std::make_tuple(Checks...);
@@ -46,6 +60,8 @@ struct Items {
 
 struct Additional {};
 
+struct Columnar {};
+
 
 template <typename Field, auto Value>
 constexpr inline std::enable_if_t<!meta::kIsOptional<Field>, bool>
@@ -96,11 +112,27 @@ constexpr inline auto Check(const std::string& field, Pattern<Regex>) noexcept {
   return utils::regex_match(field, kRegex<Regex>);
 };
 
+template <typename Field, utils::ConstexprString Regex>
+constexpr inline std::enable_if_t<std::is_enum_v<Field>, bool>
+Check(const Field& field, Pattern<Regex>) noexcept {
+  return utils::regex_match(EnumeratorName(field), kRegex<Regex>);
+};
+
 template <typename Field, auto Value>
 constexpr inline auto Check(const std::optional<Field>&, Default<Value>) noexcept {
   return true;
 };
 
+template <typename... Alternatives, utils::ConstexprString Name>
+constexpr inline auto Check(const std::variant<Alternatives...>&, Discriminator<Name>) noexcept {
+  return true;
+};
+
+template <typename Row>
+constexpr inline auto Check(const std::vector<Row>&, Columnar) noexcept {
+  return true;
+};
+
 template <typename Field>
 constexpr inline
 std::enable_if_t<!meta::kIsOptional<Field>, bool>
@@ -151,9 +183,18 @@ constexpr inline auto ErrorMessage(const std::unordered_map<Key, Value>& field,
   return fmt::format("Error with field {0} Map size: {1} Maximum Size: {2}", boost::pfr::get_name<I, T>(), field.size(), Maximum);
 };
 
+template <typename Field>
+constexpr inline decltype(auto) Printable(const Field& field) noexcept {
+  if constexpr(std::is_enum_v<Field>) {
+    return EnumeratorName(field);
+  } else {
+    return field;
+  };
+};
+
 template <typename T, auto I, typename Field, template <auto> typename Check, auto Value>
 constexpr inline auto ErrorMessage(const Field& field, Check<Value>) {
-  return fmt::format("Error with field {0} Field value: {1} Check Value: {2}", boost::pfr::get_name<I, T>(), field, Value);
+  return fmt::format("Error with field {0} Field value: {1} Check Value: {2}", boost::pfr::get_name<I, T>(), Printable(field), Printable(Value));
 };
 
 
@@ -189,6 +230,11 @@ inline constexpr impl::Items<Params...> Items;
 
 inline constexpr impl::Additional Additional;
 
+inline constexpr impl::Columnar Columnar;
+
+template <utils::ConstexprString... Names>
+inline constexpr impl::Enum<Names...> Enum;
+
 template <utils::ConstexprString Regex>
 inline constexpr impl::Pattern<Regex> Pattern;
 
@@ -198,6 +244,9 @@ inline constexpr impl::MaxItems<Value> MaxItems;
 template <std::size_t Value>
 inline constexpr impl::MinItems<Value> MinItems;
 
+template <utils::ConstexprString Name>
+inline constexpr impl::Discriminator<Name> Discriminator;
+
 } // namespace formats::universal
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include "basic_checks.hpp"
+#include "projection.hpp"
+#include "buffer_pool.hpp"
+#include <userver/formats/json.hpp>
+
+namespace {
+
+struct Routing {
+  std::string tenant;
+  std::string type;
+};
+
+struct Order {
+  std::string tenant;
+  std::string type;
+  std::vector<int> items;
+};
+
+std::string MakePayload(std::size_t size, bool fieldsAtEnd) {
+  std::string items;
+  for(std::size_t i = 0; items.size() < size; i++) {
+    items += fmt::format(R"({{"id":{0},"name":"item {0}","tags":["a","b","c"],"price":{1}.5}},)", i, i * 3);
+  };
+  items.pop_back();
+  constexpr std::string_view kHeader = R"("tenant":"acme","type":"order")";
+  return fieldsAtEnd
+      ? fmt::format(R"({{"items":[{0}],{1}}})", items, kHeader)
+      : fmt::format(R"({{{1},"items":[{0}]}})", items, kHeader);
+};
+
+} // namespace
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Routing> =
+    SerializationConfig<Routing>::Create();
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Order> =
+    SerializationConfig<Order>::Create();
+
+void ParseDom(benchmark::State& state) {
+  const auto payload = MakePayload(state.range(0), state.range(1));
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::json::FromString(payload).As<Routing>());
+  };
+  state.SetBytesProcessed(state.iterations() * payload.size());
+};
+BENCHMARK(ParseDom)->ArgsProduct({{1 << 10, 64 << 10, 1 << 20, 4 << 20}, {0, 1}})->ArgNames({"bytes", "fieldsAtEnd"});
+
+void ParseProjection(benchmark::State& state) {
+  const auto payload = MakePayload(state.range(0), state.range(1));
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::universal::ParseProjection<Routing>(payload));
+  };
+  state.SetBytesProcessed(state.iterations() * payload.size());
+};
+BENCHMARK(ParseProjection)->ArgsProduct({{1 << 10, 64 << 10, 1 << 20, 4 << 20}, {0, 1}})->ArgNames({"bytes", "fieldsAtEnd"});
+
+void SerializeToString(benchmark::State& state) {
+  const Order order{"acme", "order", std::vector<int>(state.range(0), 42)};
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::json::ToString(userver::formats::json::ValueBuilder(order).ExtractValue()));
+  };
+};
+BENCHMARK(SerializeToString)->Arg(16)->Arg(1 << 10)->Arg(64 << 10);
+
+void SerializeToPooledString(benchmark::State& state) {
+  const Order order{"acme", "order", std::vector<int>(state.range(0), 42)};
+  for([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(userver::formats::universal::ToPooledString(order));
+  };
+  const auto stats = userver::formats::universal::GetBufferPoolStatistics();
+  state.counters["hits"] = static_cast<double>(stats.hits);
+  state.counters["reallocations"] = static_cast<double>(stats.reallocations);
+};
+BENCHMARK(SerializeToPooledString)->Arg(16)->Arg(1 << 10)->Arg(64 << 10);
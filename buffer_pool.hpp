@@ -0,0 +1,217 @@
+#pragma once
+#include <userver/formats/universal/universal.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+namespace formats::universal {
+
+struct BufferPoolStatistics {
+  std::uint64_t hits;
+  std::uint64_t misses;
+  std::uint64_t reallocations;
+  std::size_t bytesHeld;
+};
+
+namespace impl {
+
+inline constexpr std::size_t kMaxPooledBuffers = 16;
+inline constexpr std::size_t kMaxPooledCapacity = 1 << 20;
+
+struct BufferPoolCounters {
+  std::atomic<std::uint64_t> hits{0};
+  std::atomic<std::uint64_t> misses{0};
+  std::atomic<std::uint64_t> reallocations{0};
+  std::atomic<std::size_t> bytesHeld{0};
+};
+
+inline BufferPoolCounters bufferPoolCounters;
+
+struct BufferPool {
+  std::vector<std::string> buffers;
+  BufferPool() = default;
+  BufferPool(BufferPool&&) = default;
+  ~BufferPool() {
+    for(const auto& buffer : this->buffers) {
+      bufferPoolCounters.bytesHeld -= buffer.capacity();
+    };
+  };
+};
+
+// Scopes of bufferPool.Use() never span a suspension point, so a buffer may be
+// acquired on one thread and released into the pool of another one.
+inline compiler::ThreadLocal bufferPool = [] {
+  BufferPool pool;
+  pool.buffers.reserve(kMaxPooledBuffers);
+  return pool;
+};
+
+inline std::string AcquireBuffer(std::size_t estimate) {
+  std::string buffer;
+  bool hit = false;
+  {
+    auto pool = bufferPool.Use();
+    if(!pool->buffers.empty()) {
+      buffer = std::move(pool->buffers.back());
+      pool->buffers.pop_back();
+      hit = true;
+    };
+  };
+  if(hit) {
+    bufferPoolCounters.hits++;
+    bufferPoolCounters.bytesHeld -= buffer.capacity();
+  } else {
+    bufferPoolCounters.misses++;
+  };
+  if(estimate > buffer.capacity()) {
+    buffer.reserve(estimate);
+    bufferPoolCounters.reallocations++;
+  };
+  return buffer;
+};
+
+inline void ReleaseBuffer(std::string&& buffer) noexcept {
+  if(buffer.capacity() <= std::string{}.capacity() || buffer.capacity() > kMaxPooledCapacity) {
+    return;
+  };
+  buffer.clear();
+  const auto capacity = buffer.capacity();
+  auto pool = bufferPool.Use();
+  if(pool->buffers.size() < kMaxPooledBuffers) {
+    pool->buffers.push_back(std::move(buffer));
+    bufferPoolCounters.bytesHeld += capacity;
+  };
+};
+
+template <typename T>
+inline std::atomic<std::size_t> sizeEstimate{0};
+
+inline void UpdateEstimate(std::atomic<std::size_t>& estimate, std::size_t size) noexcept {
+  const auto old = estimate.load(std::memory_order_relaxed);
+  estimate.store(old == 0 ? size : old - old / 8 + size / 8, std::memory_order_relaxed);
+};
+
+// Collects writes in a put area over a fixed chunk and appends them to the
+// buffer chunk by chunk, so the buffer never holds unwritten storage
+class StringSink final : public std::streambuf {
+  public:
+    explicit StringSink(std::string& buffer) noexcept : buffer(buffer) {
+      this->setp(this->chunk.data(), this->chunk.data() + this->chunk.size());
+    };
+    constexpr std::uint64_t Reallocations() const noexcept {
+      return this->reallocations;
+    };
+    void Finish() {
+      this->Flush();
+    };
+  protected:
+    std::streamsize xsputn(const char* str, std::streamsize size) override {
+      const auto length = static_cast<std::size_t>(size);
+      if(length > static_cast<std::size_t>(this->epptr() - this->pptr())) {
+        this->Flush();
+        if(length >= this->chunk.size()) {
+          this->Append(str, length);
+          return size;
+        };
+      };
+      traits_type::copy(this->pptr(), str, length);
+      this->pbump(static_cast<int>(length));
+      return size;
+    };
+    int_type overflow(int_type c) override {
+      this->Flush();
+      if(!traits_type::eq_int_type(c, traits_type::eof())) {
+        *this->pptr() = traits_type::to_char_type(c);
+        this->pbump(1);
+      };
+      return traits_type::not_eof(c);
+    };
+    int sync() override {
+      this->Flush();
+      return 0;
+    };
+  private:
+    void Flush() {
+      this->Append(this->pbase(), static_cast<std::size_t>(this->pptr() - this->pbase()));
+      this->setp(this->chunk.data(), this->chunk.data() + this->chunk.size());
+    };
+    void Append(const char* str, std::size_t size) {
+      const auto capacity = this->buffer.capacity();
+      this->buffer.append(str, size);
+      if(this->buffer.capacity() != capacity) {
+        this->reallocations++;
+      };
+    };
+    static constexpr std::size_t kChunkSize = 512;
+    std::string& buffer;
+    std::uint64_t reallocations = 0;
+    std::array<char, kChunkSize> chunk;
+};
+
+} // namespace impl
+
+class PooledBuffer {
+  public:
+    explicit PooledBuffer(std::string&& buffer) noexcept : buffer(std::move(buffer)) {};
+    PooledBuffer(PooledBuffer&&) noexcept = default;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept {
+      if(this != &other) {
+        impl::ReleaseBuffer(std::move(this->buffer));
+        this->buffer = std::move(other.buffer);
+      };
+      return *this;
+    };
+    ~PooledBuffer() {
+      impl::ReleaseBuffer(std::move(this->buffer));
+    };
+    const std::string& Get() const noexcept {
+      return this->buffer;
+    };
+    std::string_view GetView() const noexcept {
+      return this->buffer;
+    };
+  private:
+    std::string buffer;
+};
+
+template <typename T>
+inline PooledBuffer ToPooledString(const T& obj) {
+  const auto value = formats::json::ValueBuilder(obj).ExtractValue();
+  auto& estimate = impl::sizeEstimate<T>;
+  const auto expected = estimate.load(std::memory_order_relaxed);
+  auto buffer = impl::AcquireBuffer(expected + expected / 8);
+  impl::StringSink sink(buffer);
+  std::ostream stream(&sink);
+  formats::json::Serialize(value, stream);
+  sink.Finish();
+  impl::bufferPoolCounters.reallocations += sink.Reallocations();
+  impl::UpdateEstimate(estimate, buffer.size());
+  return PooledBuffer(std::move(buffer));
+};
+
+inline BufferPoolStatistics GetBufferPoolStatistics() noexcept {
+  const auto& counters = impl::bufferPoolCounters;
+  return {counters.hits.load(), counters.misses.load(), counters.reallocations.load(), counters.bytesHeld.load()};
+};
+
+inline void DumpMetric(utils::statistics::Writer& writer, const BufferPoolStatistics& stats) {
+  writer["hits"] = stats.hits;
+  writer["misses"] = stats.misses;
+  writer["hit-rate"] = stats.hits + stats.misses == 0 ? 0.0 : static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses);
+  writer["reallocations"] = stats.reallocations;
+  writer["bytes-held"] = stats.bytesHeld;
+};
+
+} // namespace formats::universal
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,158 @@
+#pragma once
+#include <userver/formats/universal/universal.hpp>
+#include <userver/utils/meta.hpp>
+#include "string.hpp"
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+namespace formats::universal::impl {
+
+struct LiteralSizeWriter {
+  std::size_t size = 0;
+  constexpr void Write(char) noexcept {
+    this->size++;
+  };
+};
+
+template <std::size_t Size>
+struct LiteralArrayWriter {
+  std::array<char, Size> data = {};
+  std::size_t size = 0;
+  constexpr void Write(char c) noexcept {
+    this->data[this->size++] = c;
+  };
+};
+
+template <typename Writer>
+constexpr inline void WriteRaw(Writer& writer, std::string_view str) {
+  for(char c : str) {
+    writer.Write(c);
+  };
+};
+
+template <typename Writer>
+constexpr inline void WriteEscaped(Writer& writer, std::string_view str) {
+  constexpr std::string_view kHex = "0123456789abcdef";
+  writer.Write('"');
+  for(char c : str) {
+    if(c == '"' || c == '\\') {
+      writer.Write('\\');
+      writer.Write(c);
+    } else if(static_cast<unsigned char>(c) < 0x20) {
+      WriteRaw(writer, "\\u00");
+      writer.Write(kHex[static_cast<unsigned char>(c) >> 4]);
+      writer.Write(kHex[static_cast<unsigned char>(c) & 0xf]);
+    } else {
+      writer.Write(c);
+    };
+  };
+  writer.Write('"');
+};
+
+template <typename Writer, typename Field>
+constexpr inline void WriteLiteral(Writer& writer, const Field& field);
+
+template <typename T>
+struct IsPattern : public std::false_type {};
+
+template <utils::ConstexprString Regex>
+struct IsPattern<Pattern<Regex>> : public std::true_type {};
+
+template <typename Writer, typename T, typename... Params>
+constexpr inline void WriteLiteralFields(Writer& writer, const T& obj, SerializationConfig<T, Params...>) {
+  bool first = true;
+  const auto writeField = [&]<auto I, typename... FieldParams>(FieldParametries<T, I, FieldParams...>) {
+    static_assert(!utils::impl::AnyOf(utils::impl::IsSameCarried<Additional>(), utils::impl::TypeList<FieldParams...>{}),
+        "Additional is not supported in JSON literals");
+    static_assert(!utils::impl::anyOf<IsPattern>(utils::impl::TypeList<FieldParams...>{}),
+        "Pattern can not be checked at compile time in JSON literals");
+    const auto& value = boost::pfr::get<I>(obj);
+    // Thrown during constant evaluation, so a failed check is a compile error
+    if(!(Check(value, FieldParams{}) && ...)) {
+      throw std::invalid_argument("JSON literal field fails its checks");
+    };
+    const auto writeKey = [&] {
+      if(!first) {
+        writer.Write(',');
+      };
+      first = false;
+      WriteEscaped(writer, boost::pfr::get_name<I, T>());
+      writer.Write(':');
+    };
+    if constexpr(meta::kIsOptional<std::remove_cvref_t<decltype(value)>>) {
+      if(value) {
+        writeKey();
+        WriteLiteral(writer, *value);
+      } else if constexpr(utils::impl::anyOf<IsDefault>(utils::impl::TypeList<FieldParams...>{})) {
+        writeKey();
+        WriteLiteral(writer, decltype(FindParam<IsDefault, FieldParams...>())::kValue);
+      };
+    } else {
+      writeKey();
+      WriteLiteral(writer, value);
+    };
+  };
+  (writeField(Params{}), ...);
+};
+
+template <typename Writer, typename Field>
+constexpr inline void WriteLiteral(Writer& writer, const Field& field) {
+  if constexpr(std::is_same_v<Field, bool>) {
+    WriteRaw(writer, field ? "true" : "false");
+  } else if constexpr(std::is_integral_v<Field>) {
+    using Unsigned = std::make_unsigned_t<Field>;
+    Unsigned magnitude = static_cast<Unsigned>(field);
+    if(field < 0) {
+      writer.Write('-');
+      magnitude = static_cast<Unsigned>(Unsigned{0} - magnitude);
+    };
+    std::array<char, 20> digits = {};
+    std::size_t count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while(magnitude != 0);
+    while(count != 0) {
+      writer.Write(digits[--count]);
+    };
+  } else if constexpr(std::is_convertible_v<Field, std::string_view>) {
+    WriteEscaped(writer, std::string_view{field});
+  } else if constexpr(std::is_enum_v<Field>) {
+    static_assert(kIsEnumConfig<decltype(kSerialization<Field>)>, "Enum must be configured with universal::Enum");
+    WriteEscaped(writer, EnumeratorName(field));
+  } else {
+    static_assert(!std::is_same_v<decltype(kSerialization<Field>), const Disabled>,
+        "JSON literals support integers, booleans, strings, enums, optionals and configured structs");
+    writer.Write('{');
+    WriteLiteralFields(writer, field, std::remove_const_t<decltype(kSerialization<Field>)>{});
+    writer.Write('}');
+  };
+};
+
+template <const auto& kObject>
+consteval auto MakeJsonLiteral() {
+  constexpr auto kSize = [] {
+    LiteralSizeWriter writer;
+    WriteLiteral(writer, kObject);
+    return writer.size;
+  }();
+  LiteralArrayWriter<kSize + 1> writer;
+  WriteLiteral(writer, kObject);
+  return UniversalSerializeLibrary::String<kSize + 1>{writer.data};
+};
+
+template <const auto& kObject>
+inline constexpr auto kJsonLiteralString = MakeJsonLiteral<kObject>();
+
+} // namespace formats::universal::impl
+namespace formats::universal {
+
+template <const auto& kObject>
+inline constexpr std::string_view kJsonLiteral = impl::kJsonLiteralString<kObject>;
+
+} // namespace formats::universal
+
+USERVER_NAMESPACE_END
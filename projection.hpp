@@ -0,0 +1,263 @@
+#pragma once
+#include <userver/formats/universal/universal.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <fmt/format.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+namespace formats::universal::impl {
+
+class ProjectionScanner {
+  public:
+    explicit ProjectionScanner(std::string_view text) noexcept : text(text) {};
+
+    bool Consume(char c) {
+      this->SkipSpaces();
+      if(this->position < this->text.size() && this->text[this->position] == c) {
+        this->position++;
+        return true;
+      };
+      return false;
+    };
+
+    void Expect(char c) {
+      if(!this->Consume(c)) {
+        this->Fail(fmt::format("expected '{0}'", c));
+      };
+    };
+
+    // Returns the string including its quotes
+    std::string_view ScanString() {
+      this->SkipSpaces();
+      const auto start = this->position;
+      if(this->position == this->text.size() || this->text[this->position] != '"') {
+        this->Fail("expected string");
+      };
+      this->SkipString();
+      return this->text.substr(start, this->position - start);
+    };
+
+    // Skips a value without building it, nested containers included
+    std::string_view ScanValue() {
+      this->SkipSpaces();
+      const auto start = this->position;
+      if(this->position == this->text.size()) {
+        this->Fail("expected value");
+      };
+      const char first = this->text[this->position];
+      if(first == '"') {
+        this->SkipString();
+      } else if(first == '{' || first == '[') {
+        std::size_t depth = 0;
+        do {
+          const char c = this->text[this->position];
+          if(c == '"') {
+            this->SkipString();
+            continue;
+          };
+          if(c == '{' || c == '[') {
+            depth++;
+          } else if(c == '}' || c == ']') {
+            depth--;
+          };
+          this->position++;
+        } while(depth != 0 && this->position < this->text.size());
+        if(depth != 0) {
+          this->Fail("unterminated container");
+        };
+      } else {
+        while(this->position < this->text.size() && !IsDelimiter(this->text[this->position])) {
+          this->position++;
+        };
+        if(this->position == start) {
+          this->Fail("expected value");
+        };
+      };
+      return this->text.substr(start, this->position - start);
+    };
+
+  private:
+    static constexpr bool IsDelimiter(char c) noexcept {
+      return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+
+    void SkipSpaces() noexcept {
+      while(this->position < this->text.size() &&
+          (this->text[this->position] == ' ' || this->text[this->position] == '\t' ||
+           this->text[this->position] == '\r' || this->text[this->position] == '\n')) {
+        this->position++;
+      };
+    };
+
+    void SkipString() {
+      this->position++;
+      while(this->position < this->text.size()) {
+        const char c = this->text[this->position++];
+        if(c == '\\') {
+          this->position++;
+        } else if(c == '"') {
+          return;
+        };
+      };
+      this->Fail("unterminated string");
+    };
+
+    [[noreturn]] void Fail(std::string_view reason) const {
+      throw std::runtime_error(fmt::format("Projection parse error at offset {0}: {1}", this->position, reason));
+    };
+
+    std::string_view text;
+    std::size_t position = 0;
+};
+
+inline std::optional<std::uint32_t> ReadHex4(std::string_view raw, std::size_t position) noexcept {
+  if(position + 4 > raw.size()) {
+    return std::nullopt;
+  };
+  std::uint32_t result = 0;
+  for(char c : raw.substr(position, 4)) {
+    result <<= 4;
+    if(c >= '0' && c <= '9') {
+      result |= static_cast<std::uint32_t>(c - '0');
+    } else if(c >= 'a' && c <= 'f') {
+      result |= static_cast<std::uint32_t>(c - 'a' + 10);
+    } else if(c >= 'A' && c <= 'F') {
+      result |= static_cast<std::uint32_t>(c - 'A' + 10);
+    } else {
+      return std::nullopt;
+    };
+  };
+  return result;
+};
+
+// Compares a quoted JSON string with name, decoding escapes on the fly
+inline bool KeyEquals(std::string_view quoted, std::string_view name) noexcept {
+  const auto raw = quoted.substr(1, quoted.size() - 2);
+  if(raw.find('\\') == std::string_view::npos) {
+    return raw == name;
+  };
+  std::size_t matched = 0;
+  const auto match = [&](char c) {
+    if(matched == name.size() || name[matched] != c) {
+      return false;
+    };
+    matched++;
+    return true;
+  };
+  for(std::size_t i = 0; i < raw.size(); i++) {
+    if(raw[i] != '\\') {
+      if(!match(raw[i])) {
+        return false;
+      };
+      continue;
+    };
+    if(++i == raw.size()) {
+      return false;
+    };
+    char c = raw[i];
+    switch(c) {
+      case '"': case '\\': case '/': break;
+      case 'b': c = '\b'; break;
+      case 'f': c = '\f'; break;
+      case 'n': c = '\n'; break;
+      case 'r': c = '\r'; break;
+      case 't': c = '\t'; break;
+      case 'u': {
+        auto code = ReadHex4(raw, i + 1);
+        if(!code) {
+          return false;
+        };
+        i += 4;
+        if(*code >= 0xd800 && *code < 0xdc00) {
+          const auto low = raw.substr(i + 1, 2) == "\\u" ? ReadHex4(raw, i + 3) : std::nullopt;
+          if(!low || *low < 0xdc00 || *low >= 0xe000) {
+            return false;
+          };
+          code = 0x10000 + ((*code - 0xd800) << 10) + (*low - 0xdc00);
+          i += 6;
+        };
+        std::array<char, 4> utf8{};
+        std::size_t size = 0;
+        if(*code < 0x80) {
+          utf8[size++] = static_cast<char>(*code);
+        } else if(*code < 0x800) {
+          utf8[size++] = static_cast<char>(0xc0 | (*code >> 6));
+          utf8[size++] = static_cast<char>(0x80 | (*code & 0x3f));
+        } else if(*code < 0x10000) {
+          utf8[size++] = static_cast<char>(0xe0 | (*code >> 12));
+          utf8[size++] = static_cast<char>(0x80 | ((*code >> 6) & 0x3f));
+          utf8[size++] = static_cast<char>(0x80 | (*code & 0x3f));
+        } else {
+          utf8[size++] = static_cast<char>(0xf0 | (*code >> 18));
+          utf8[size++] = static_cast<char>(0x80 | ((*code >> 12) & 0x3f));
+          utf8[size++] = static_cast<char>(0x80 | ((*code >> 6) & 0x3f));
+          utf8[size++] = static_cast<char>(0x80 | (*code & 0x3f));
+        };
+        for(std::size_t j = 0; j < size; j++) {
+          if(!match(utf8[j])) {
+            return false;
+          };
+        };
+        continue;
+      };
+      default:
+        return false;
+    };
+    if(!match(c)) {
+      return false;
+    };
+  };
+  return matched == name.size();
+};
+
+} // namespace formats::universal::impl
+namespace formats::universal {
+
+template <typename Proj>
+inline Proj ParseProjection(std::string_view text) {
+  constexpr auto kNames = boost::pfr::names_as_array<Proj>();
+  std::array<std::string_view, kNames.size()> values{};
+  std::size_t found = 0;
+  impl::ProjectionScanner scanner(text);
+  scanner.Expect('{');
+  if(!scanner.Consume('}')) {
+    do {
+      const auto key = scanner.ScanString();
+      scanner.Expect(':');
+      const auto value = scanner.ScanValue();
+      for(std::size_t i = 0; i < kNames.size(); i++) {
+        if(values[i].empty() && impl::KeyEquals(key, kNames[i])) {
+          values[i] = value;
+          found++;
+          break;
+        };
+      };
+    } while(found != kNames.size() && scanner.Consume(','));
+    if(found != kNames.size()) {
+      scanner.Expect('}');
+    };
+  };
+  std::string projected = "{";
+  for(std::size_t i = 0; i < kNames.size(); i++) {
+    if(!values[i].empty()) {
+      if(projected.size() != 1) {
+        projected += ',';
+      };
+      projected += '"';
+      projected += kNames[i];
+      projected += "\":";
+      projected += values[i];
+    };
+  };
+  projected += '}';
+  return formats::json::FromString(projected).template As<Proj>();
+};
+
+} // namespace formats::universal
+
+USERVER_NAMESPACE_END
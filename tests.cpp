@@ -1,5 +1,9 @@
 #include <userver/utest/utest.hpp>
 #include "basic_checks.hpp"
+#include "allocation_counter.hpp"
+#include "json_literal.hpp"
+#include "buffer_pool.hpp"
+#include "projection.hpp"
 #include <userver/formats/json.hpp>
 
 struct SomeStruct {
@@ -195,3 +199,658 @@ UTEST(Parse, Recursive) {
   const auto fromJson = json.As<SomeStruct7>();
   EXPECT_EQ(fromJson, valid);
 };
+
+
+struct Circle {
+  int radius;
+  constexpr bool operator==(const Circle& other) const noexcept {
+    return this->radius == other.radius;
+  };
+};
+
+struct Rectangle {
+  int width;
+  int height;
+  constexpr bool operator==(const Rectangle& other) const noexcept {
+    return this->width == other.width && this->height == other.height;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Circle> =
+    SerializationConfig<Circle>::Create();
+
+template <>
+inline constexpr auto userver::formats::universal::kTag<Circle> = std::string_view{"circle"};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Rectangle> =
+    SerializationConfig<Rectangle>::Create();
+
+template <>
+inline constexpr auto userver::formats::universal::kTag<Rectangle> = std::string_view{"rectangle"};
+
+struct SomeStruct8 {
+  std::variant<Circle, Rectangle> shape;
+  constexpr bool operator==(const SomeStruct8& other) const noexcept {
+    return this->shape == other.shape;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct8> =
+    SerializationConfig<SomeStruct8>::Create()
+    .With<"shape">(Discriminator<"type">);
+
+UTEST(Serialize, Discriminator) {
+  SomeStruct8 a{Rectangle{2, 3}};
+  const auto json = userver::formats::json::ValueBuilder(a).ExtractValue();
+  EXPECT_EQ(json, userver::formats::json::FromString(R"({"shape":{"type":"rectangle","width":2,"height":3}})"));
+};
+
+UTEST(Parse, Discriminator) {
+  const auto json = userver::formats::json::FromString(R"({"shape":{"type":"circle","radius":5}})");
+  const auto json2 = userver::formats::json::FromString(R"({"shape":{"type":"triangle","radius":5}})");
+  const SomeStruct8 valid{Circle{5}};
+  EXPECT_EQ(json.As<SomeStruct8>(), valid);
+  EXPECT_THROW(json2.As<SomeStruct8>(), std::runtime_error);
+};
+
+UTEST(TryParse, Discriminator) {
+  const auto json = userver::formats::json::FromString(R"({"shape":{"type":"rectangle","width":2,"height":3}})");
+  const auto json2 = userver::formats::json::FromString(R"({"shape":{"type":"triangle","radius":5}})");
+  const auto json3 = userver::formats::json::FromString(R"({"shape":{"type":"circle","width":2}})");
+  const SomeStruct8 valid{Rectangle{2, 3}};
+  EXPECT_EQ(userver::formats::parse::TryParse(json, userver::formats::parse::To<SomeStruct8>{}), valid);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct8>{}), false);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json3, userver::formats::parse::To<SomeStruct8>{}), false);
+};
+
+
+namespace {
+
+std::string MakeNested(std::size_t depth) {
+  std::string result;
+  for(std::size_t i = 0; i < depth; i++) {
+    result += R"({"value":)" + std::to_string(i) + R"(,"children":[)";
+  };
+  result += R"({"value":)" + std::to_string(depth) + R"(,"children":[]})";
+  for(std::size_t i = 0; i < depth; i++) {
+    result += "]}";
+  };
+  return result;
+};
+
+} // namespace
+
+UTEST(Serialize, Recursive) {
+  SomeStruct7 a{1, {{2, {}}, {3, {{4, {}}}}}};
+  const auto json = userver::formats::json::ValueBuilder(a).ExtractValue();
+  EXPECT_EQ(json, userver::formats::json::FromString(
+      R"({"value":1,"children":[{"value":2,"children":[]},{"value":3,"children":[{"value":4,"children":[]}]}]})"));
+  EXPECT_EQ(json.As<SomeStruct7>(), a);
+};
+
+UTEST(Parse, MaxDepth) {
+  using userver::formats::universal::kMaxDepth;
+  const auto json = userver::formats::json::FromString(MakeNested(kMaxDepth<SomeStruct7> - 1));
+  const auto json2 = userver::formats::json::FromString(MakeNested(kMaxDepth<SomeStruct7>));
+  EXPECT_NO_THROW(userver::formats::universal::DestroyIteratively(json.As<SomeStruct7>()));
+  EXPECT_THROW(json2.As<SomeStruct7>(), std::runtime_error);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct7>{}), false);
+};
+
+struct SomeStruct9 {
+  int value;
+  std::vector<SomeStruct9> children;
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct9> =
+    SerializationConfig<SomeStruct9>::Create()
+    .With<"children">(MaxItems<1>);
+
+template <>
+inline constexpr std::size_t userver::formats::universal::kMaxDepth<SomeStruct9> =
+    userver::formats::universal::kMaxRecursiveDepth;
+
+UTEST(Parse, DeepRecursive) {
+  constexpr std::size_t kDepth = userver::formats::universal::kMaxDepth<SomeStruct9> - 1;
+  const auto json = userver::formats::json::FromString(MakeNested(kDepth));
+  auto fromJson = json.As<SomeStruct9>();
+  const SomeStruct9* node = &fromJson;
+  std::size_t depth = 0;
+  for(; !node->children.empty(); depth++) {
+    EXPECT_EQ(node->value, static_cast<int>(depth));
+    node = &node->children.front();
+  };
+  EXPECT_EQ(depth, kDepth);
+
+  const auto serialized = userver::formats::json::ValueBuilder(fromJson).ExtractValue();
+  auto element = serialized;
+  for(depth = 0; element["children"].GetSize() != 0; depth++) {
+    element = element["children"][0];
+  };
+  EXPECT_EQ(depth, kDepth);
+
+  auto tried = userver::formats::parse::TryParse(json, userver::formats::parse::To<SomeStruct9>{});
+  ASSERT_TRUE(tried);
+  node = &*tried;
+  for(depth = 0; !node->children.empty(); depth++) {
+    node = &node->children.front();
+  };
+  EXPECT_EQ(depth, kDepth);
+
+  std::string invalid = MakeNested(kDepth);
+  const std::string_view leaf = R"("children":[])";
+  invalid.replace(invalid.find(leaf), leaf.size(), R"("children":[{"value":0,"children":[]},{"value":1,"children":[]}])");
+  const auto json2 = userver::formats::json::FromString(invalid);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct9>{}), false);
+};
+
+struct SomeStruct15 {
+  int value;
+  std::vector<SomeStruct15> children;
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct15> =
+    SerializationConfig<SomeStruct15>::Create();
+
+template <>
+inline constexpr std::size_t userver::formats::universal::kMaxDepth<SomeStruct15> =
+    userver::formats::universal::kMaxRecursiveDepth;
+
+UTEST(TryParse, DeepRecursiveInvalidSibling) {
+  using userver::formats::universal::kMaxDepth;
+  // The first child is a finished subtree of maximum depth when its sibling fails
+  const auto json = userver::formats::json::FromString(
+      R"({"value":0,"children":[)" + MakeNested(kMaxDepth<SomeStruct15> - 2) + R"(,{"value":"bad","children":[]}]})");
+  const auto json2 = userver::formats::json::FromString(
+      R"({"value":0,"children":[)" + MakeNested(kMaxDepth<SomeStruct15> - 2) + R"(,{"value":1}]})");
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json, userver::formats::parse::To<SomeStruct15>{}), false);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct15>{}), false);
+  EXPECT_THROW(json.As<SomeStruct15>(), std::exception);
+};
+
+
+struct Record {
+  int id;
+  std::string name;
+  std::optional<int> score;
+  bool operator==(const Record& other) const noexcept {
+    return this->id == other.id && this->name == other.name && this->score == other.score;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Record> =
+    SerializationConfig<Record>::Create()
+    .With<"id">(Min<0>);
+
+struct SomeStruct10 {
+  std::vector<Record> records;
+  bool operator==(const SomeStruct10& other) const noexcept {
+    return this->records == other.records;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct10> =
+    SerializationConfig<SomeStruct10>::Create()
+    .With<"records">(Columnar);
+
+UTEST(Serialize, Columnar) {
+  SomeStruct10 a{{{1, "first", 10}, {2, "second", {}}}};
+  const auto json = userver::formats::json::ValueBuilder(a).ExtractValue();
+  EXPECT_EQ(json, userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"],"score":[10,null]}})"));
+};
+
+UTEST(Parse, Columnar) {
+  const auto json = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"],"score":[10,null]}})");
+  const auto json2 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"]}})");
+  const auto json3 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first"]}})");
+  const auto json4 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"],"score":[]}})");
+  const SomeStruct10 valid{{{1, "first", 10}, {2, "second", {}}}};
+  const SomeStruct10 valid2{{{1, "first", {}}, {2, "second", {}}}};
+  EXPECT_EQ(json.As<SomeStruct10>(), valid);
+  EXPECT_EQ(json2.As<SomeStruct10>(), valid2);
+  EXPECT_THROW(json3.As<SomeStruct10>(), std::runtime_error);
+  EXPECT_THROW(json4.As<SomeStruct10>(), std::runtime_error);
+};
+
+UTEST(TryParse, Columnar) {
+  const auto json = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"],"score":[10,null]}})");
+  const auto json2 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first"]}})");
+  const auto json3 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,-2],"name":["first","second"]}})");
+  const auto json4 = userver::formats::json::FromString(
+      R"({"records":{"id":[1,2],"name":["first","second"],"score":[]}})");
+  const SomeStruct10 valid{{{1, "first", 10}, {2, "second", {}}}};
+  EXPECT_EQ(userver::formats::parse::TryParse(json, userver::formats::parse::To<SomeStruct10>{}), valid);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct10>{}), false);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json3, userver::formats::parse::To<SomeStruct10>{}), false);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json4, userver::formats::parse::To<SomeStruct10>{}), false);
+};
+
+struct SomeStruct11 {
+  std::string_view name;
+  bool enabled;
+  SomeStruct limits;
+  std::optional<int> retries;
+  std::optional<int> timeout;
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct11> =
+    SerializationConfig<SomeStruct11>::Create()
+    .With<"retries">(Default<3>);
+
+inline constexpr SomeStruct11 kSomeStruct11{"health \"ok\"", true, {10, -100}, {}, {}};
+
+static_assert(userver::formats::universal::kJsonLiteral<kSomeStruct11> ==
+    R"({"name":"health \"ok\"","enabled":true,"limits":{"field1":10,"field2":-100},"retries":3})");
+
+inline constexpr SomeStruct4 kSomeStruct4{11};
+
+static_assert(userver::formats::universal::kJsonLiteral<kSomeStruct4> == R"({"field":11})");
+
+UTEST(Serialize, JsonLiteral) {
+  const auto json = userver::formats::json::ValueBuilder(kSomeStruct11).ExtractValue();
+  EXPECT_EQ(userver::formats::json::ToString(json), userver::formats::universal::kJsonLiteral<kSomeStruct11>);
+};
+
+UTEST(Serialize, PooledBuffer) {
+  using userver::formats::universal::GetBufferPoolStatistics;
+  using userver::formats::universal::ToPooledString;
+  const SomeStruct a{10, 100};
+  {
+    const auto buffer = ToPooledString(a);
+    EXPECT_EQ(buffer.GetView(), "{\"field1\":10,\"field2\":100}");
+  };
+  const auto before = GetBufferPoolStatistics();
+  {
+    const auto buffer = ToPooledString(a);
+    EXPECT_EQ(buffer.GetView(), "{\"field1\":10,\"field2\":100}");
+  };
+  const auto after = GetBufferPoolStatistics();
+  EXPECT_EQ(after.hits - before.hits, 1u);
+  EXPECT_EQ(after.misses - before.misses, 0u);
+  EXPECT_EQ(after.reallocations - before.reallocations, 0u);
+  EXPECT_EQ(after.bytesHeld, before.bytesHeld);
+  {
+    // The second buffer misses the pool and reserves the estimate
+    auto buffer = ToPooledString(a);
+    buffer = ToPooledString(a);
+    EXPECT_EQ(buffer.GetView(), "{\"field1\":10,\"field2\":100}");
+  };
+  const auto assigned = GetBufferPoolStatistics();
+  EXPECT_EQ(assigned.reallocations - after.reallocations, 1u);
+  {
+    const auto first = ToPooledString(a);
+    const auto second = ToPooledString(a);
+  };
+  EXPECT_EQ(GetBufferPoolStatistics().hits - assigned.hits, 2u);
+};
+
+struct SomeStruct12 {
+  std::string tenant;
+  int type;
+  std::optional<int> priority;
+  constexpr bool operator==(const SomeStruct12& other) const noexcept {
+    return this->tenant == other.tenant && this->type == other.type && this->priority == other.priority;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct12> =
+    SerializationConfig<SomeStruct12>::Create()
+    .With<"type">(Min<1>)
+    .With<"priority">(Default<5>);
+
+UTEST(ParseProjection, Basic) {
+  using userver::formats::universal::ParseProjection;
+  const SomeStruct12 valid{"acme", 2, 5};
+  const SomeStruct12 valid2{"acme", 2, 1};
+  EXPECT_EQ(ParseProjection<SomeStruct12>(
+      R"({"body":{"tenant":"other","list":[1,"]}",{"a":[]}]},"type":2,"te\u006eant":"acme","x":null})"), valid);
+  EXPECT_EQ(ParseProjection<SomeStruct12>(
+      R"({ "priority" : 1, "tenant" : "acme", "type" : 2, "rest": this is never scanned)"), valid2);
+  EXPECT_EQ(ParseProjection<SomeStruct12>(
+      R"({"t\ud83d\ude00":1,"tenant\n":"other","ty\/pe":7,"tenant":"acme","type":2,"priority":5})"), valid);
+  EXPECT_THROW(ParseProjection<SomeStruct12>(R"({"tenant":"acme","type":0})"), std::runtime_error);
+  EXPECT_ANY_THROW(ParseProjection<SomeStruct12>(R"({"tenant":"acme"})"));
+  EXPECT_THROW(ParseProjection<SomeStruct12>(R"({"tenant":"acme")"), std::runtime_error);
+};
+
+enum class Color {
+  kRed,
+  kGreen,
+  kBlue
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Color> = Enum<>;
+
+enum class Level {
+  kLow,
+  kMedium,
+  kHigh
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Level> = Enum<"low", "medium", "high">;
+
+struct SomeStruct13 {
+  Color color;
+  std::vector<Level> levels;
+  bool operator==(const SomeStruct13& other) const noexcept {
+    return this->color == other.color && this->levels == other.levels;
+  };
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct13> =
+    SerializationConfig<SomeStruct13>::Create()
+    .With<"color">(Pattern<"^k(Red|Green)$">)
+    .With<"levels">(Items<Pattern<"^(low|medium)$">>);
+
+struct SomeStruct14 {
+  Color color;
+  Level level;
+};
+
+namespace {
+
+enum class Mode {
+  kFast,
+  kSafe
+};
+
+} // namespace
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Mode> = Enum<>;
+
+enum class Approval {
+  kWaitingForApproval,
+  kApproved
+};
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<Approval> = Enum<>;
+
+template <>
+inline constexpr auto userver::formats::universal::kSerialization<SomeStruct14> =
+    SerializationConfig<SomeStruct14>::Create();
+
+inline constexpr SomeStruct14 kSomeStruct14{Color::kBlue, Level::kMedium};
+
+static_assert(userver::formats::universal::kJsonLiteral<kSomeStruct14> == R"({"color":"kBlue","level":"medium"})");
+
+UTEST(Serialize, Enum) {
+  SomeStruct13 a{Color::kGreen, {Level::kLow, Level::kMedium}};
+  const auto json = userver::formats::json::ValueBuilder(a).ExtractValue();
+  EXPECT_EQ(json, userver::formats::json::FromString(R"({"color":"kGreen","levels":["low","medium"]})"));
+  EXPECT_THROW(userver::formats::json::ValueBuilder(static_cast<Level>(10)), std::runtime_error);
+};
+
+UTEST(Parse, Enum) {
+  const auto json = userver::formats::json::FromString(R"({"color":"kRed","levels":["medium"]})");
+  const auto json2 = userver::formats::json::FromString(R"({"color":"kBlue","levels":["medium"]})");
+  const auto json3 = userver::formats::json::FromString(R"({"color":"kPurple","levels":[]})");
+  const SomeStruct13 valid{Color::kRed, {Level::kMedium}};
+  EXPECT_EQ(json.As<SomeStruct13>(), valid);
+  EXPECT_THROW(json2.As<SomeStruct13>(), std::runtime_error);
+  EXPECT_THROW(json3.As<SomeStruct13>(), std::runtime_error);
+};
+
+UTEST(TryParse, Enum) {
+  const auto json = userver::formats::json::FromString(R"({"color":"kRed","levels":["low"]})");
+  const auto json2 = userver::formats::json::FromString(R"({"color":"kRed","levels":["high"]})");
+  const auto json3 = userver::formats::json::FromString(R"({"color":"kRed","levels":["extreme"]})");
+  const SomeStruct13 valid{Color::kRed, {Level::kLow}};
+  EXPECT_EQ(userver::formats::parse::TryParse(json, userver::formats::parse::To<SomeStruct13>{}), valid);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json2, userver::formats::parse::To<SomeStruct13>{}), false);
+  EXPECT_EQ((bool)userver::formats::parse::TryParse(json3, userver::formats::parse::To<SomeStruct13>{}), false);
+};
+
+namespace {
+
+// Runs func once before counting, so that lazily initialized statics
+// (regexes, thread-locals) are not attributed to the measured call
+template <typename Func>
+std::size_t CountWarm(Func&& func) {
+  func();
+  return UniversalSerializeLibrary::CountAllocations(func).allocations;
+};
+
+template <typename T>
+std::size_t CountParse(const userver::formats::json::Value& json) {
+  return CountWarm([&]{
+    return json.As<T>();
+  });
+};
+
+template <typename T>
+std::size_t CountTryParse(const userver::formats::json::Value& json) {
+  return CountWarm([&]{
+    return userver::formats::parse::TryParse(json, userver::formats::parse::To<T>{});
+  });
+};
+
+template <typename T>
+std::size_t CountSerialize(const T& value) {
+  return CountWarm([&]{
+    return userver::formats::json::ValueBuilder(value).ExtractValue();
+  });
+};
+
+// Hand-written equivalent of ValueBuilder(value).ExtractValue(): the Value
+// built by build() goes through the same ValueBuilder(Value&&) conversion
+template <typename Build>
+std::size_t CountBuild(Build&& build) {
+  return CountWarm([&]{
+    return userver::formats::json::ValueBuilder(build()).ExtractValue();
+  });
+};
+
+} // namespace
+
+UTEST(Parse, EnumAnonymousNamespace) {
+  const auto json = userver::formats::json::FromString(R"(["kSafe","kFast"])");
+  EXPECT_EQ(json[0].As<Mode>(), Mode::kSafe);
+  EXPECT_EQ(json[1].As<Mode>(), Mode::kFast);
+  EXPECT_EQ(userver::formats::json::ValueBuilder(Mode::kSafe).ExtractValue().As<std::string>(), "kSafe");
+};
+
+UTEST(Allocations, Counter) {
+  const auto stats = UniversalSerializeLibrary::CountAllocations([]{
+    return std::vector<int>(10);
+  });
+  EXPECT_EQ(stats.allocations, 1u);
+  EXPECT_EQ(stats.deallocations, 0u);
+  EXPECT_EQ(stats.bytes, 10 * sizeof(int));
+};
+
+// Each count is pinned to the hand-written code doing the same work plus the
+// allocations the library adds on its own, so any new allocation fails
+UTEST(Allocations, Basic) {
+  const auto json = userver::formats::json::FromString("{\"field1\":10,\"field2\":100}");
+  const auto parse = CountWarm([&]{
+    return SomeStruct{json["field1"].As<int>(), json["field2"].As<int>()};
+  });
+  const auto serialize = CountBuild([]{
+    userver::formats::json::ValueBuilder builder;
+    builder["field1"] = 10;
+    builder["field2"] = 100;
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(parse, 0u);
+  EXPECT_EQ(CountParse<SomeStruct>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct>(json), parse);
+  EXPECT_EQ(CountSerialize(SomeStruct{10, 100}), serialize);
+};
+
+UTEST(Allocations, Optional) {
+  const auto json = userver::formats::json::FromString("{\"field2\":100}");
+  const auto parse = CountWarm([&]{
+    return SomeStruct2{
+      json["field1"].As<std::optional<int>>().value_or(114),
+      json["field2"].As<std::optional<int>>(),
+      json["field3"].As<std::optional<int>>()};
+  });
+  const auto serialize = CountBuild([]{
+    userver::formats::json::ValueBuilder builder;
+    builder["field1"] = 114;
+    builder["field2"] = 100;
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct2>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct2>(json), parse);
+  EXPECT_EQ(CountSerialize(SomeStruct2{{}, 100, {}}), serialize);
+};
+
+UTEST(Allocations, Additional) {
+  const auto json = userver::formats::json::FromString("{\"data1\":1,\"data2\":2}");
+  const auto value = json.As<SomeStruct3>();
+  const auto parse = CountWarm([&]{
+    std::unordered_map<std::string, int> field;
+    for(const auto& [name, element] : userver::formats::common::Items(json)) {
+      field[name] = element.As<int>();
+    };
+    return SomeStruct3{std::move(field)};
+  });
+  const auto serialize = CountBuild([&]{
+    userver::formats::json::ValueBuilder builder;
+    for(const auto& element : value.field) {
+      builder[element.first] = element.second;
+    };
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct3>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct3>(json), parse);
+  EXPECT_EQ(CountSerialize(value), serialize);
+};
+
+UTEST(Allocations, MinMax) {
+  const auto json = userver::formats::json::FromString("{\"field\":11}");
+  const auto serialize = CountBuild([]{
+    userver::formats::json::ValueBuilder builder;
+    builder["field"] = 11;
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct4>(json), 0u);
+  EXPECT_EQ(CountTryParse<SomeStruct4>(json), 0u);
+  EXPECT_EQ(CountSerialize(SomeStruct4{11}), serialize);
+};
+
+UTEST(Allocations, Pattern) {
+  const auto json = userver::formats::json::FromString(R"({"field":"1234412"})");
+  const userver::utils::regex regex("^[0-9]+$");
+  const auto parse = CountWarm([&]{
+    auto field = json["field"].As<std::string>();
+    return std::make_pair(userver::utils::regex_match(field, regex), SomeStruct5{std::move(field)});
+  });
+  const auto serialize = CountBuild([&]{
+    const std::string field = "1234412";
+    [[maybe_unused]] const bool matched = userver::utils::regex_match(field, regex);
+    userver::formats::json::ValueBuilder builder;
+    builder["field"] = field;
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct5>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct5>(json), parse);
+  EXPECT_EQ(CountSerialize(SomeStruct5{"1234412"}), serialize);
+};
+
+UTEST(Allocations, Arrays) {
+  const auto json = userver::formats::json::FromString(R"({"field":[[10], [20]]})");
+  const SomeStruct6 value{{{10}, {20}}};
+  const auto parse = CountWarm([&]{
+    return SomeStruct6{json["field"].As<std::vector<std::vector<int>>>()};
+  });
+  const auto serialize = CountBuild([&]{
+    userver::formats::json::ValueBuilder builder;
+    builder["field"] = value.field;
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct6>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct6>(json), parse);
+  EXPECT_EQ(CountSerialize(value), serialize);
+};
+
+UTEST(Allocations, Recursive) {
+  const auto json = userver::formats::json::FromString(R"({"value":1,"children":[{"value":2,"children":[]}]})");
+  const auto parse = CountWarm([&]{
+    std::vector<SomeStruct7> children;
+    children.reserve(json["children"].GetSize());
+    children.push_back(SomeStruct7{json["children"][0]["value"].As<int>(), {}});
+    return SomeStruct7{json["value"].As<int>(), std::move(children)};
+  });
+  const auto serialize = CountBuild([]{
+    userver::formats::json::ValueBuilder builder;
+    builder["value"] = 1;
+    userver::formats::json::ValueBuilder children(userver::formats::common::Type::kArray);
+    children.Resize(1);
+    builder["children"] = std::move(children);
+    auto child = builder["children"][0];
+    child["value"] = 2;
+    child["children"] = userver::formats::json::ValueBuilder(userver::formats::common::Type::kArray);
+    return builder.ExtractValue();
+  });
+  // Parsing grows the explicit stack to two frames, serializing allocates
+  // the stack and one builder handle for the child
+  constexpr std::size_t kParseStack = 2;
+  constexpr std::size_t kSerializeStack = 2;
+  EXPECT_EQ(CountParse<SomeStruct7>(json), parse + kParseStack);
+  EXPECT_EQ(CountTryParse<SomeStruct7>(json), parse + kParseStack);
+  EXPECT_EQ(CountSerialize(SomeStruct7{1, {{2, {}}}}), serialize + kSerializeStack);
+};
+
+UTEST(Allocations, Discriminator) {
+  const auto json = userver::formats::json::FromString(R"({"shape":{"type":"circle","radius":5}})");
+  const auto parse = CountWarm([&]{
+    const auto shape = json["shape"];
+    if(shape["type"].As<std::string>() != "circle") {
+      throw std::runtime_error("unexpected type");
+    };
+    return SomeStruct8{Circle{shape["radius"].As<int>()}};
+  });
+  // The alternative itself goes through its own serializer, pinned by Basic
+  const auto serialize = CountBuild([]{
+    userver::formats::json::ValueBuilder builder;
+    auto element = builder["shape"];
+    element = Circle{5};
+    element["type"] = std::string("circle");
+    return builder.ExtractValue();
+  });
+  EXPECT_EQ(CountParse<SomeStruct8>(json), parse);
+  EXPECT_EQ(CountTryParse<SomeStruct8>(json), parse);
+  EXPECT_EQ(CountSerialize(SomeStruct8{Circle{5}}), serialize);
+};
+
+UTEST(Allocations, Enum) {
+  const auto json = userver::formats::json::FromString(R"({"color":"kBlue","level":"medium"})");
+  EXPECT_EQ(CountParse<SomeStruct14>(json), 0u);
+  EXPECT_EQ(CountTryParse<SomeStruct14>(json), 0u);
+};
+
+UTEST(Allocations, EnumLongName) {
+  const auto json = userver::formats::json::FromString(R"({"approval":"kWaitingForApproval"})");
+  const auto parse = CountWarm([&]{
+    return json["approval"].As<std::string>();
+  });
+  EXPECT_EQ(json["approval"].As<Approval>(), Approval::kWaitingForApproval);
+  EXPECT_EQ(CountWarm([&]{ return json["approval"].As<Approval>(); }), parse);
+  EXPECT_EQ(CountWarm([&]{
+    return userver::formats::parse::TryParse(json["approval"], userver::formats::parse::To<Approval>{});
+  }), parse);
+};
@@ -7,8 +7,21 @@
 #include <userver/formats/serialize/to.hpp>
 #include <userver/formats/common/meta.hpp>
 #include <userver/formats/common/items.hpp>
+#include <userver/formats/common/type.hpp>
+#include <userver/utils/meta.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/formats/parse/try_parse.hpp>
 #include <unordered_map>
+#include <algorithm>
+#include <variant>
+#include <array>
+#include <bit>
+#include <optional>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <fmt/format.h>
 #include <boost/pfr/core_name.hpp>
 #include <boost/pfr/core.hpp>
 
@@ -21,11 +34,25 @@ struct Disabled {};
 
 struct Additional;
 
+struct Columnar;
+
 template <auto>
 struct Default;
 
+template <utils::ConstexprString>
+struct Discriminator;
+
+template <utils::ConstexprString>
+struct Pattern;
+
+template <utils::ConstexprString...>
+struct Enum;
+
 } //namespace impl
 
+template <typename T, typename... Params>
+class SerializationConfig;
+
 template <auto... Params>
 struct Configurator {
   using kParams = utils::impl::TypeList<decltype(Params)...>;
@@ -37,6 +64,17 @@ inline static constexpr auto kSerialization = impl::Disabled{};
 template <typename T>
 inline static constexpr auto kDeserialization = kSerialization<T>;
 
+template <typename T>
+inline static constexpr auto kTag = impl::Disabled{};
+
+template <typename T>
+inline static constexpr std::size_t kMaxDepth = 128;
+
+// Types holding std::vector<T> fields are parsed and serialized without
+// recursion, but ~T() still recurses, so their kMaxDepth may not exceed the
+// depth a coroutine stack survives
+inline constexpr std::size_t kMaxRecursiveDepth = 1024;
+
 namespace impl {
 
 template <auto Needed, auto Value, typename T, typename F>
@@ -55,6 +93,271 @@ struct FieldParametries {
   using kFieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
 };
 
+constexpr inline std::uint64_t Hash(std::string_view str, std::uint64_t seed) noexcept {
+  std::uint64_t hash = 14695981039346656037ULL ^ seed;
+  for(char c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  };
+  return hash;
+};
+
+constexpr inline std::uint64_t Mix(std::uint64_t hash, std::uint64_t displacement) noexcept {
+  hash ^= displacement * 0x9e3779b97f4a7c15ULL;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+};
+
+// Hash and displace: keys are grouped into buckets by their hash, and each
+// bucket gets the displacement that moves all of its keys into free slots
+template <std::size_t N>
+struct PerfectHash {
+  static constexpr std::size_t kSize = std::bit_ceil(N + N / 4 + 1);
+  static constexpr std::size_t kBuckets = N / 2 + 1;
+  std::array<std::string_view, N> keys;
+  std::array<std::uint32_t, kBuckets> displacements;
+  std::array<std::size_t, kSize> slots;
+  constexpr std::optional<std::size_t> Find(std::string_view key) const noexcept {
+    const auto hash = Hash(key, 0);
+    const auto slot = this->slots[Mix(hash, this->displacements[hash % kBuckets]) & (kSize - 1)];
+    if(slot < N && this->keys[slot] == key) {
+      return slot;
+    };
+    return std::nullopt;
+  };
+};
+
+template <std::size_t N>
+consteval auto MakePerfectHash(std::array<std::string_view, N> keys) {
+  using Result = PerfectHash<N>;
+  constexpr std::uint32_t kMaxDisplacement = 1 << 16;
+  Result result{keys, {}, {}};
+  result.slots.fill(N);
+  std::array<std::uint64_t, N> hashes{};
+  std::array<std::size_t, Result::kBuckets> sizes{};
+  std::array<std::size_t, N> order{};
+  for(std::size_t i = 0; i < N; i++) {
+    hashes[i] = Hash(keys[i], 0);
+    sizes[hashes[i] % Result::kBuckets]++;
+    order[i] = i;
+  };
+  // Largest buckets first, keys of one bucket next to each other
+  std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs){
+    const auto lhsBucket = hashes[lhs] % Result::kBuckets;
+    const auto rhsBucket = hashes[rhs] % Result::kBuckets;
+    if(sizes[lhsBucket] != sizes[rhsBucket]) {
+      return sizes[lhsBucket] > sizes[rhsBucket];
+    };
+    return lhsBucket != rhsBucket ? lhsBucket < rhsBucket : lhs < rhs;
+  });
+  for(std::size_t begin = 0; begin < N;) {
+    const auto bucket = hashes[order[begin]] % Result::kBuckets;
+    const auto end = begin + sizes[bucket];
+    for(std::size_t i = begin; i < end; i++) {
+      for(std::size_t j = i + 1; j < end; j++) {
+        if(keys[order[i]] == keys[order[j]]) {
+          throw "Duplicate key in perfect hash";
+        };
+      };
+    };
+    std::uint32_t displacement = 0;
+    for(;; displacement++) {
+      if(displacement == kMaxDisplacement) {
+        throw "No displacement found for perfect hash bucket";
+      };
+      std::size_t placed = begin;
+      for(; placed < end; placed++) {
+        auto& slot = result.slots[Mix(hashes[order[placed]], displacement) & (Result::kSize - 1)];
+        if(slot != N) {
+          break;
+        };
+        slot = order[placed];
+      };
+      if(placed == end) {
+        break;
+      };
+      for(std::size_t i = begin; i < placed; i++) {
+        result.slots[Mix(hashes[order[i]], displacement) & (Result::kSize - 1)] = N;
+      };
+    };
+    result.displacements[bucket] = displacement;
+    begin = end;
+  };
+  return result;
+};
+
+template <typename E, std::size_t Count, std::size_t Range>
+struct EnumTable {
+  std::underlying_type_t<E> min;
+  std::array<std::string_view, Range> names;
+  std::array<E, Count> values;
+  PerfectHash<Count> hash;
+  constexpr std::string_view Name(E value) const noexcept {
+    const auto index = static_cast<std::size_t>(static_cast<std::underlying_type_t<E>>(value) - this->min);
+    return index < Range ? this->names[index] : std::string_view{};
+  };
+  constexpr std::optional<E> Find(std::string_view name) const noexcept {
+    const auto index = this->hash.Find(name);
+    if(!index) {
+      return std::nullopt;
+    };
+    return this->values[*index];
+  };
+};
+
+template <auto Value>
+consteval std::string_view ReflectEnumeratorName() {
+  // GCC: "... [with auto Value = Color::kRed]", Clang: "... [Value = Color::kRed]",
+  // the scope may be "(anonymous namespace)::" or "{anonymous}::", and values
+  // without an enumerator are printed as "(Color)5"
+  std::string_view name = __PRETTY_FUNCTION__;
+  const auto start = name.find("Value = ") + 8;
+  name = name.substr(start, name.find_first_of(";]", start) - start);
+  const auto scope = name.rfind(':');
+  name = scope == std::string_view::npos ? name : name.substr(scope + 1);
+  const auto isIdentifier = [](char c, bool first) {
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (!first && c >= '0' && c <= '9');
+  };
+  if(name.empty() || !isIdentifier(name.front(), true)) {
+    return {};
+  };
+  for(char c : name) {
+    if(!isIdentifier(c, false)) {
+      return {};
+    };
+  };
+  return name;
+};
+
+template <typename E>
+consteval auto MakeReflectedEnumTable() {
+  using Underlying = std::underlying_type_t<E>;
+  constexpr long long kLow = std::max<long long>(-128, std::numeric_limits<Underlying>::min());
+  constexpr long long kHigh = std::min<long long>(127, std::numeric_limits<Underlying>::max());
+  constexpr auto kNames = []<auto... I>(std::index_sequence<I...>){
+    return std::array<std::string_view, sizeof...(I)>{
+      ReflectEnumeratorName<static_cast<E>(kLow + static_cast<long long>(I))>()...
+    };
+  }(std::make_index_sequence<kHigh - kLow + 1>());
+  constexpr auto kCount = static_cast<std::size_t>(std::count_if(kNames.begin(), kNames.end(), [](auto name){
+    return !name.empty();
+  }));
+  static_assert(kCount != 0, "No enumerators found by reflection, use Enum<\"name\", ...>");
+  constexpr auto kFirst = static_cast<std::size_t>(std::find_if(kNames.begin(), kNames.end(), [](auto name){
+    return !name.empty();
+  }) - kNames.begin());
+  constexpr auto kLast = kNames.size() - 1 - static_cast<std::size_t>(std::find_if(kNames.rbegin(), kNames.rend(), [](auto name){
+    return !name.empty();
+  }) - kNames.rbegin());
+  EnumTable<E, kCount, kLast - kFirst + 1> result{static_cast<Underlying>(kLow + static_cast<long long>(kFirst)), {}, {}, {}};
+  std::array<std::string_view, kCount> keys{};
+  std::size_t count = 0;
+  for(std::size_t i = kFirst; i <= kLast; i++) {
+    result.names[i - kFirst] = kNames[i];
+    if(!kNames[i].empty()) {
+      keys[count] = kNames[i];
+      result.values[count++] = static_cast<E>(kLow + static_cast<long long>(i));
+    };
+  };
+  result.hash = MakePerfectHash<kCount>(keys);
+  return result;
+};
+
+template <typename E, utils::ConstexprString... Names>
+consteval auto MakeEnumTable(Enum<Names...>) {
+  if constexpr(sizeof...(Names) == 0) {
+    return MakeReflectedEnumTable<E>();
+  } else {
+    constexpr auto kReflected = MakeReflectedEnumTable<E>();
+    static_assert(kReflected.values.size() == sizeof...(Names) && [&]{
+      for(std::size_t i = 0; i < sizeof...(Names); i++) {
+        if(kReflected.values[i] != static_cast<E>(i)) {
+          return false;
+        };
+      };
+      return true;
+    }(), "Enum<\"name\", ...> names the enumerators 0, 1, ... in order of value");
+    constexpr std::array<std::string_view, sizeof...(Names)> kNames{std::string_view{Names}...};
+    EnumTable<E, sizeof...(Names), sizeof...(Names)> result{0, kNames, {}, MakePerfectHash<sizeof...(Names)>(kNames)};
+    for(std::size_t i = 0; i < sizeof...(Names); i++) {
+      result.values[i] = static_cast<E>(i);
+    };
+    return result;
+  };
+};
+
+template <typename T>
+struct IsEnumConfig : public std::false_type {};
+
+template <utils::ConstexprString... Names>
+struct IsEnumConfig<Enum<Names...>> : public std::true_type {};
+
+template <typename T>
+inline constexpr bool kIsEnumConfig = IsEnumConfig<std::remove_cvref_t<T>>::value;
+
+template <typename E>
+inline constexpr auto kEnumTable = MakeEnumTable<E>(std::remove_const_t<decltype(kSerialization<E>)>{});
+
+template <typename E>
+constexpr inline std::string_view EnumeratorName(E value) noexcept {
+  if constexpr(kIsEnumConfig<decltype(kSerialization<E>)>) {
+    return kEnumTable<E>.Name(value);
+  } else {
+    return {};
+  };
+};
+
+inline std::size_t ChangeDepth(std::ptrdiff_t delta) noexcept {
+  static compiler::ThreadLocal depth = [] { return std::size_t{0}; };
+  auto scope = depth.Use();
+  return *scope += delta;
+};
+
+template <typename T>
+class DepthGuard {
+  public:
+    DepthGuard() noexcept : exceeded(ChangeDepth(1) > kMaxDepth<T>) {};
+    DepthGuard(const DepthGuard&) = delete;
+    DepthGuard& operator=(const DepthGuard&) = delete;
+    ~DepthGuard() {
+      ChangeDepth(-1);
+    };
+    constexpr bool Exceeded() const noexcept {
+      return this->exceeded;
+    };
+  private:
+    bool exceeded;
+};
+
+template <typename T>
+inline auto DepthErrorMessage() {
+  return fmt::format("Maximum nesting depth {0} exceeded", kMaxDepth<T>);
+};
+
+template <typename T, typename Field>
+inline constexpr bool kIsRecursiveField = std::is_same_v<Field, std::vector<T>>;
+
+template <typename T>
+consteval bool IsRecursive() {
+  return []<auto... I>(std::index_sequence<I...>){
+    return (kIsRecursiveField<T, boost::pfr::tuple_element_t<I, T>> || ...);
+  }(std::make_index_sequence<boost::pfr::tuple_size_v<T>>());
+};
+
+template <typename T>
+inline constexpr auto kRecursiveFields = []<auto... I>(std::index_sequence<I...>){
+  return std::array<std::vector<T>*(*)(T&), sizeof...(I)>{
+    +[](T& obj) -> std::vector<T>* {
+      if constexpr(kIsRecursiveField<T, boost::pfr::tuple_element_t<I, T>>) {
+        return &boost::pfr::get<I>(obj);
+      } else {
+        return nullptr;
+      };
+    }...
+  };
+}(std::make_index_sequence<boost::pfr::tuple_size_v<T>>());
+
 template <typename Field>
 constexpr inline auto Check(const Field&, Disabled) noexcept {
   return true;
@@ -137,6 +440,15 @@ Read(const From& value, parse::To<std::optional<std::unordered_map<std::string,
   return Read<T, I, Params...>(value, parse::To<std::unordered_map<std::string, Value>>{});
 };
 
+template <template <typename> typename Trait, typename Param, typename... Params>
+consteval auto FindParam() {
+  if constexpr(Trait<Param>::value) {
+    return Param{};
+  } else {
+    return FindParam<Trait, Params...>();
+  };
+};
+
 template <typename T>
 struct IsDefault : public std::false_type {};
 
@@ -172,6 +484,256 @@ constexpr inline std::optional<Field> Read(Value&& value, parse::To<std::optiona
 };
 
 
+template <typename T>
+struct IsDiscriminator : public std::false_type {};
+
+template <utils::ConstexprString Name>
+struct IsDiscriminator<Discriminator<Name>> : public std::true_type {};
+
+template <typename... Alternatives>
+consteval auto MakeTagsHash() {
+  static_assert((!std::is_same_v<decltype(kTag<Alternatives>), const Disabled> && ...),
+      "Every variant alternative must specialize universal::kTag");
+  return MakePerfectHash<sizeof...(Alternatives)>({std::string_view{kTag<Alternatives>}...});
+};
+
+template <typename... Alternatives>
+inline constexpr auto kTagsHash = MakeTagsHash<Alternatives...>();
+
+template <typename T>
+consteval bool HasField(std::string_view name) {
+  constexpr auto names = boost::pfr::names_as_array<T>();
+  return std::find(names.begin(), names.end(), name) != names.end();
+};
+
+template <typename DiscriminatorT, typename... Alternatives>
+consteval std::string_view DiscriminatorName() {
+  constexpr std::string_view kName = DiscriminatorT::kValue;
+  static_assert((!HasField<Alternatives>(kName) && ...),
+      "A variant alternative declares a field with the same name as the Discriminator");
+  return kName;
+};
+
+template <typename Value, typename... Alternatives>
+inline constexpr std::array<std::variant<Alternatives...>(*)(const Value&), sizeof...(Alternatives)> kVariantParsers{
+  +[](const Value& value) -> std::variant<Alternatives...> {
+    return value.template As<Alternatives>();
+  }...
+};
+
+template <typename Value, typename... Alternatives>
+inline constexpr std::array<std::optional<std::variant<Alternatives...>>(*)(const Value&), sizeof...(Alternatives)> kVariantTryParsers{
+  +[](const Value& value) -> std::optional<std::variant<Alternatives...>> {
+    using parse::TryParse;
+    auto response = TryParse(value, parse::To<Alternatives>{});
+    if(!response) {
+      return std::nullopt;
+    };
+    return std::move(*response);
+  }...
+};
+
+template <typename T, auto I, typename... Params, typename Value, typename... Alternatives>
+constexpr inline
+std::enable_if_t<utils::impl::anyOf<IsDiscriminator>(utils::impl::TypeList<Params...>{}), std::variant<Alternatives...>>
+Read(Value&& value, parse::To<std::variant<Alternatives...>>) {
+  constexpr auto kName = DiscriminatorName<decltype(FindParam<IsDiscriminator, Params...>()), Alternatives...>();
+  const auto field = value[boost::pfr::get_name<I, T>()];
+  const auto tag = field[kName].template As<std::string>();
+  const auto index = kTagsHash<Alternatives...>.Find(tag);
+  if(!index) {
+    throw std::runtime_error(fmt::format("Error with field {0} Unknown {1}: {2}", boost::pfr::get_name<I, T>(), kName, tag));
+  };
+  return kVariantParsers<std::remove_cvref_t<decltype(field)>, Alternatives...>[*index](field);
+};
+
+template <typename T, auto I, typename... Params, typename Value, typename... Alternatives>
+constexpr inline
+std::enable_if_t<utils::impl::anyOf<IsDiscriminator>(utils::impl::TypeList<Params...>{}), std::optional<std::variant<Alternatives...>>>
+Read(Value&& value, parse::To<std::optional<std::variant<Alternatives...>>>) {
+  using parse::TryParse;
+  constexpr auto kName = DiscriminatorName<decltype(FindParam<IsDiscriminator, Params...>()), Alternatives...>();
+  const auto field = value[boost::pfr::get_name<I, T>()];
+  const auto tag = TryParse(field[kName], parse::To<std::string>{});
+  if(!tag) {
+    return std::nullopt;
+  };
+  const auto index = kTagsHash<Alternatives...>.Find(*tag);
+  if(!index) {
+    return std::nullopt;
+  };
+  return kVariantTryParsers<std::remove_cvref_t<decltype(field)>, Alternatives...>[*index](field);
+};
+
+template <typename T, auto I, typename... Params, typename Builder, typename... Alternatives>
+constexpr inline std::enable_if_t<utils::impl::anyOf<IsDiscriminator>(utils::impl::TypeList<Params...>{}), void>
+RunWrite(Builder& builder, const std::variant<Alternatives...>& field) {
+  constexpr auto kName = DiscriminatorName<decltype(FindParam<IsDiscriminator, Params...>()), Alternatives...>();
+  std::visit([&]<typename Alternative>(const Alternative& alternative){
+    auto element = builder[std::string(boost::pfr::get_name<I, T>())];
+    element = alternative;
+    element[std::string(kName)] = std::string(std::string_view{kTag<Alternative>});
+  }, field);
+};
+
+
+// Columns are read and written field by field, bypassing the row's own
+// Read/RunWrite, so row fields may only carry checks and Default
+template <typename Config>
+inline constexpr bool kIsPlainRowConfig = []<typename Row, typename... RowParams>(SerializationConfig<Row, RowParams...>){
+  return ([]<auto I, typename... Params>(FieldParametries<Row, I, Params...>){
+    using List = utils::impl::TypeList<Params...>;
+    return !utils::impl::anyOf<IsDiscriminator>(List{})
+        && !utils::impl::AnyOf(utils::impl::IsSameCarried<Columnar>(), List{})
+        && !utils::impl::AnyOf(utils::impl::IsSameCarried<Additional>(), List{});
+  }(RowParams{}) && ...);
+}(Config{});
+
+template <typename Field>
+struct Column {
+  std::vector<Field> values;
+  bool missing = false;
+};
+
+template <typename Row, auto I, bool Try, typename Value, typename... Params>
+inline std::optional<Column<typename FieldParametries<Row, I, Params...>::kFieldType>>
+ReadColumn(FieldParametries<Row, I, Params...>, const Value& columns) {
+  using FieldType = typename FieldParametries<Row, I, Params...>::kFieldType;
+  using parse::TryParse;
+  const auto column = columns[boost::pfr::get_name<I, Row>()];
+  if constexpr(meta::kIsOptional<FieldType>) {
+    if(column.IsMissing()) {
+      return Column<FieldType>{{}, true};
+    };
+  };
+  if constexpr(Try) {
+    auto values = TryParse(column, parse::To<std::vector<FieldType>>{});
+    if(!values) {
+      return std::nullopt;
+    };
+    return Column<FieldType>{std::move(*values)};
+  } else {
+    return Column<FieldType>{column.template As<std::vector<FieldType>>()};
+  };
+};
+
+template <typename Row, auto I, typename... Params, typename Field>
+inline void FillColumn(Column<Field>& column, std::size_t rows) {
+  if constexpr(meta::kIsOptional<Field>) {
+    if(column.missing) {
+      column.values.resize(rows);
+    };
+    if constexpr(utils::impl::anyOf<IsDefault>(utils::impl::TypeList<Params...>{})) {
+      for(auto& element : column.values) {
+        if(!element) {
+          element = decltype(FindParam<IsDefault, Params...>())::kValue;
+        };
+      };
+    };
+  };
+};
+
+template <typename Row, bool Try, typename Value>
+inline std::optional<std::vector<Row>> ReadColumnar(const Value& columns) {
+  using Config = std::remove_const_t<decltype(kDeserialization<Row>)>;
+  static_assert(kIsPlainRowConfig<Config>, "Columnar rows support only checks and Default");
+  return [&]<typename... RowParams>(SerializationConfig<Row, RowParams...>) -> std::optional<std::vector<Row>> {
+    auto data = std::make_tuple(ReadColumn<Row, RowParams::kIndex, Try>(RowParams{}, columns)...);
+    constexpr auto fieldsCount = sizeof...(RowParams);
+    return [&]<auto... I>(std::index_sequence<I...>) -> std::optional<std::vector<Row>> {
+      if(!(std::get<I>(data) && ...)) {
+        return std::nullopt;
+      };
+      const std::size_t rows = std::max({std::get<I>(data)->values.size()...});
+      ([&]<typename... Params>(FieldParametries<Row, I, Params...>){
+        FillColumn<Row, I, Params...>(*std::get<I>(data), rows);
+      }(RowParams{}), ...);
+      for(const auto size : {std::get<I>(data)->values.size()...}) {
+        if(size != rows) {
+          if constexpr(Try) {
+            return std::nullopt;
+          } else {
+            throw std::runtime_error(fmt::format("Error with columnar field: column size {0} Rows: {1}", size, rows));
+          };
+        };
+      };
+      const auto check = [&]<auto J, typename... Params>(FieldParametries<Row, J, Params...>) {
+        using exam::Check;
+        using exam::RunParseCheckFor;
+        for(const auto& element : std::get<J>(data)->values) {
+          if constexpr(Try) {
+            if(!(Check(element, Params{}) && ...)) {
+              return false;
+            };
+          } else {
+            (RunParseCheckFor<Row, J>(columns, element, Params{}), ...);
+          };
+        };
+        return true;
+      };
+      if(!(check(RowParams{}) && ...)) {
+        return std::nullopt;
+      };
+      std::vector<Row> result;
+      result.reserve(rows);
+      for(std::size_t row = 0; row < rows; row++) {
+        result.push_back(Row{std::move(std::get<I>(data)->values[row])...});
+      };
+      return result;
+    }(std::make_index_sequence<fieldsCount>());
+  }(Config{});
+};
+
+template <typename T, auto I, typename... Params, typename Value, typename Row>
+constexpr inline
+std::enable_if_t<utils::impl::AnyOf(utils::impl::IsSameCarried<Columnar>(), utils::impl::TypeList<Params...>{}), std::vector<Row>>
+Read(Value&& value, parse::To<std::vector<Row>>) {
+  return *ReadColumnar<Row, false>(value[boost::pfr::get_name<I, T>()]);
+};
+
+template <typename T, auto I, typename... Params, typename Value, typename Row>
+constexpr inline
+std::enable_if_t<utils::impl::AnyOf(utils::impl::IsSameCarried<Columnar>(), utils::impl::TypeList<Params...>{}), std::optional<std::vector<Row>>>
+Read(Value&& value, parse::To<std::optional<std::vector<Row>>>) {
+  return ReadColumnar<Row, true>(value[boost::pfr::get_name<I, T>()]);
+};
+
+template <typename Row, auto I, typename Builder, typename... Params>
+inline void WriteColumn(FieldParametries<Row, I, Params...>, Builder& columns, const std::vector<Row>& rows) {
+  using exam::RunParseCheckFor;
+  using FieldType = typename FieldParametries<Row, I, Params...>::kFieldType;
+  Builder column(common::Type::kArray);
+  for(const auto& row : rows) {
+    const auto& value = boost::pfr::get<I>(row);
+    (RunParseCheckFor<Row, I>(columns, value, Params{}), ...);
+    if constexpr(meta::kIsOptional<FieldType>) {
+      if(value) {
+        column.PushBack(Builder(*value));
+      } else if constexpr(utils::impl::anyOf<IsDefault>(utils::impl::TypeList<Params...>{})) {
+        column.PushBack(Builder(decltype(FindParam<IsDefault, Params...>())::kValue));
+      } else {
+        column.PushBack(Builder(common::Type::kNull));
+      };
+    } else {
+      column.PushBack(Builder(value));
+    };
+  };
+  columns[std::string(boost::pfr::get_name<I, Row>())] = std::move(column);
+};
+
+template <typename T, auto I, typename... Params, typename Builder, typename Row>
+constexpr inline std::enable_if_t<utils::impl::AnyOf(utils::impl::IsSameCarried<Columnar>(), utils::impl::TypeList<Params...>{}), void>
+RunWrite(Builder& builder, const std::vector<Row>& field) {
+  using Config = std::remove_const_t<decltype(kSerialization<Row>)>;
+  static_assert(kIsPlainRowConfig<Config>, "Columnar rows support only checks and Default");
+  Builder columns(common::Type::kObject);
+  [&]<typename... RowParams>(SerializationConfig<Row, RowParams...>){
+    (WriteColumn(RowParams{}, columns, field), ...);
+  }(Config{});
+  builder[std::string(boost::pfr::get_name<I, T>())] = std::move(columns);
+};
+
+
 template <typename T, auto I, typename Builder, typename Field, auto Value>
 constexpr inline auto RunCheckFor(Builder& builder, const std::optional<Field>& field, Default<Value>) {
   if(!field.has_value()) {
@@ -244,6 +806,73 @@ UniversalTryParseField(
   return std::nullopt;
 };
 
+template <typename T, auto I, typename Format, typename... Params>
+constexpr inline auto UniversalParseNode(
+     FieldParametries<T, I, Params...> field
+    ,Format&& from) {
+  using FieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
+  if constexpr(kIsRecursiveField<T, FieldType>) {
+    return FieldType{};
+  } else {
+    return UniversalParseField(field, std::forward<Format>(from));
+  };
+};
+
+template <typename T, auto I, typename Format, typename... Params>
+constexpr inline auto UniversalCheckNode(
+     FieldParametries<T, I, Params...>
+    ,Format&& from
+    ,const T& obj) {
+  using FieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
+  if constexpr(kIsRecursiveField<T, FieldType>) {
+    using exam::RunParseCheckFor;
+    (RunParseCheckFor<T, I>(from, boost::pfr::get<I>(obj), Params{}), ...);
+  };
+};
+
+template <typename T, auto I, typename Format, typename... Params>
+constexpr inline auto UniversalTryParseNode(
+     FieldParametries<T, I, Params...> field
+    ,Format&& from) noexcept {
+  using FieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
+  if constexpr(kIsRecursiveField<T, FieldType>) {
+    return std::optional<FieldType>{FieldType{}};
+  } else {
+    return UniversalTryParseField(field, std::forward<Format>(from));
+  };
+};
+
+template <typename T, auto I, typename... Params>
+constexpr inline bool UniversalTryCheckNode(
+     FieldParametries<T, I, Params...>
+    ,const T& obj) noexcept {
+  using FieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
+  if constexpr(kIsRecursiveField<T, FieldType>) {
+    using exam::Check;
+    return (Check(boost::pfr::get<I>(obj), Params{}) && ...);
+  } else {
+    return true;
+  };
+};
+
+template <typename T, auto I, typename Builder, typename... Params>
+constexpr inline auto UniversalSerializeNode(
+     FieldParametries<T, I, Params...> field
+    ,Builder& builder
+    ,const T& obj) {
+  using FieldType = std::remove_cvref_t<decltype(boost::pfr::get<I>(std::declval<T>()))>;
+  if constexpr(kIsRecursiveField<T, FieldType>) {
+    using exam::RunCheckFor;
+    const auto& value = boost::pfr::get<I>(obj);
+    (RunCheckFor<T, I>(builder, value, Params{}), ...);
+    Builder array(common::Type::kArray);
+    array.Resize(value.size());
+    builder[std::string(boost::pfr::get_name<I, T>())] = std::move(array);
+  } else {
+    UniversalSerializeField(field, builder, obj);
+  };
+};
+
 } // namespace impl
 
 template <typename T, typename... Params>
@@ -310,40 +939,249 @@ class SerializationConfig {
 };
 
 
+// Releases a value of a recursive type without recursing into ~T()
+template <typename T>
+inline void DestroyIteratively(T&& obj) {
+  using Type = std::remove_cvref_t<T>;
+  static_assert(impl::IsRecursive<Type>(), "DestroyIteratively needs a type with std::vector<T> fields");
+  std::vector<Type> pending;
+  pending.push_back(std::move(obj));
+  while(!pending.empty()) {
+    Type node = std::move(pending.back());
+    pending.pop_back();
+    for(const auto& field : impl::kRecursiveFields<Type>) {
+      if(auto* children = field(node)) {
+        for(auto& child : *children) {
+          pending.push_back(std::move(child));
+        };
+      };
+    };
+  };
+};
+
+namespace impl {
+
+template <typename T, bool Try, typename Format>
+inline std::optional<T> IterativeParse(const Format& from) {
+  static_assert(kMaxDepth<T> <= kMaxRecursiveDepth, "kMaxDepth of a recursive type exceeds kMaxRecursiveDepth");
+  using Config = std::remove_const_t<decltype(kDeserialization<T>)>;
+  constexpr auto kNames = boost::pfr::names_as_array<T>();
+  struct Frame {
+    Format value;
+    T result;
+    std::size_t field = 0;
+    std::size_t child = 0;
+    Format children = {};
+  };
+  const auto parseNode = [](const Format& value) -> std::optional<T> {
+    return [&]<typename... Params>(SerializationConfig<T, Params...>) -> std::optional<T> {
+      if constexpr(Try) {
+        auto fields = std::make_tuple(UniversalTryParseNode(Params{}, value)...);
+        return std::apply([](auto&... field) -> std::optional<T> {
+          if(!(field && ...)) {
+            return std::nullopt;
+          };
+          return T{std::move(*field)...};
+        }, fields);
+      } else {
+        return T{UniversalParseNode(Params{}, value)...};
+      };
+    }(Config{});
+  };
+  const auto checkNode = [](const Format& value, const T& obj) {
+    return [&]<typename... Params>(SerializationConfig<T, Params...>){
+      if constexpr(Try) {
+        return (UniversalTryCheckNode(Params{}, obj) && ...);
+      } else {
+        (UniversalCheckNode(Params{}, value, obj), ...);
+        return true;
+      };
+    }(Config{});
+  };
+  auto root = parseNode(from);
+  if(!root) {
+    return std::nullopt;
+  };
+  std::vector<Frame> stack;
+  // On failure the frames left on the stack hold finished subtrees
+  struct Release {
+    std::vector<Frame>& stack;
+    ~Release() {
+      for(auto& frame : this->stack) {
+        DestroyIteratively(std::move(frame.result));
+      };
+    };
+  } release{stack};
+  stack.push_back(Frame{from, std::move(*root)});
+  for(;;) {
+    auto& frame = stack.back();
+    if(frame.field == kNames.size()) {
+      if(!checkNode(frame.value, frame.result)) {
+        return std::nullopt;
+      };
+      T result = std::move(frame.result);
+      stack.pop_back();
+      if(stack.empty()) {
+        return result;
+      };
+      auto& parent = stack.back();
+      kRecursiveFields<T>[parent.field](parent.result)->push_back(std::move(result));
+      continue;
+    };
+    auto* children = kRecursiveFields<T>[frame.field](frame.result);
+    if(!children) {
+      frame.field++;
+      continue;
+    };
+    if(frame.child == 0) {
+      frame.children = frame.value[kNames[frame.field]];
+      if constexpr(Try) {
+        if(frame.children.IsMissing() || !frame.children.IsArray()) {
+          return std::nullopt;
+        };
+      };
+      children->reserve(frame.children.GetSize());
+    };
+    if(frame.child == frame.children.GetSize()) {
+      frame.field++;
+      frame.child = 0;
+      continue;
+    };
+    if(stack.size() >= kMaxDepth<T>) {
+      if constexpr(Try) {
+        return std::nullopt;
+      } else {
+        throw std::runtime_error(DepthErrorMessage<T>());
+      };
+    };
+    Format value = frame.children[frame.child++];
+    auto node = parseNode(value);
+    if(!node) {
+      return std::nullopt;
+    };
+    stack.push_back(Frame{std::move(value), std::move(*node)});
+  };
+};
+
+template <typename Value, typename T>
+inline Value IterativeSerialize(const T& obj) {
+  static_assert(kMaxDepth<T> <= kMaxRecursiveDepth, "kMaxDepth of a recursive type exceeds kMaxRecursiveDepth");
+  using Config = std::remove_const_t<decltype(kSerialization<T>)>;
+  using Builder = typename Value::Builder;
+  constexpr auto kNames = boost::pfr::names_as_array<T>();
+  struct Task {
+    const T* obj;
+    std::unique_ptr<Builder> builder;
+    std::size_t depth;
+  };
+  std::vector<Task> stack;
+  const auto serializeNode = [&](const T& node, Builder& builder, std::size_t depth) {
+    [&]<typename... Params>(SerializationConfig<T, Params...>){
+      (UniversalSerializeNode(Params{}, builder, node), ...);
+    }(Config{});
+    const auto pushChildren = [&]<typename Field>(const Field& children, std::string_view name) {
+      if constexpr(kIsRecursiveField<T, Field>) {
+        if(!children.empty() && depth >= kMaxDepth<T>) {
+          throw std::runtime_error(DepthErrorMessage<T>());
+        };
+        for(std::size_t i = 0; i < children.size(); i++) {
+          stack.push_back(Task{&children[i], std::unique_ptr<Builder>(new Builder(builder[std::string(name)][i])), depth + 1});
+        };
+      };
+    };
+    [&]<auto... I>(std::index_sequence<I...>){
+      (pushChildren(boost::pfr::get<I>(node), kNames[I]), ...);
+    }(std::make_index_sequence<kNames.size()>());
+  };
+  Builder builder;
+  serializeNode(obj, builder, 1);
+  while(!stack.empty()) {
+    auto task = std::move(stack.back());
+    stack.pop_back();
+    serializeNode(*task.obj, *task.builder, task.depth);
+  };
+  return builder.ExtractValue();
+};
+
+} // namespace impl
+
 } // namespace formats::universal
 namespace formats::parse {
 
 template <typename Format, typename T>
 constexpr inline
-std::enable_if_t<!std::is_same_v<decltype(universal::kDeserialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>, T>
+std::enable_if_t<!std::is_same_v<decltype(universal::kDeserialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>
+    && !universal::impl::kIsEnumConfig<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>, T>
 Parse(Format&& from,
     To<T>) {
   using Config = std::remove_const_t<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>;
   using Type = std::remove_cvref_t<T>;
-  return [from = std::forward<Format>(from)]<typename... Params>(universal::SerializationConfig<Type, Params...>){
-    return T{universal::impl::UniversalParseField(Params{}, std::forward<Format>(from))...};
-  }(Config{});
+  universal::impl::DepthGuard<Type> guard;
+  if(guard.Exceeded()) {
+    throw std::runtime_error(universal::impl::DepthErrorMessage<Type>());
+  };
+  if constexpr(universal::impl::IsRecursive<Type>()) {
+    return *universal::impl::IterativeParse<Type, false>(from);
+  } else {
+    return [from = std::forward<Format>(from)]<typename... Params>(universal::SerializationConfig<Type, Params...>){
+      return T{universal::impl::UniversalParseField(Params{}, std::forward<Format>(from))...};
+    }(Config{});
+  };
 };
 
 template <typename Format, typename T>
 constexpr inline
-std::enable_if_t<!std::is_same_v<decltype(universal::kDeserialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>, std::optional<T>>
+std::enable_if_t<!std::is_same_v<decltype(universal::kDeserialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>
+    && !universal::impl::kIsEnumConfig<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>, std::optional<T>>
 TryParse(Format&& from,
     To<T>) {
   using Config = std::remove_const_t<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>;
   using Type = std::remove_cvref_t<T>;
-  return [&]<typename... Params>(universal::SerializationConfig<Type, Params...>) -> std::optional<T> {
-    auto fields = std::make_tuple(universal::impl::UniversalTryParseField(Params{}, from)...);
-    constexpr auto fieldsCount = boost::pfr::tuple_size_v<T>;
-    if([&]<auto... I>(std::index_sequence<I...>){
-      return (std::get<I>(fields) && ...);
-    }(std::make_index_sequence<fieldsCount>())) {
-      return [&]<auto... I>(std::index_sequence<I...>){
-        return T{*std::get<I>(fields)...};
-      }(std::make_index_sequence<fieldsCount>());
-    };
+  universal::impl::DepthGuard<Type> guard;
+  if(guard.Exceeded()) {
     return std::nullopt;
-  }(Config{});
+  };
+  if constexpr(universal::impl::IsRecursive<Type>()) {
+    return universal::impl::IterativeParse<Type, true>(from);
+  } else {
+    return [&]<typename... Params>(universal::SerializationConfig<Type, Params...>) -> std::optional<T> {
+      auto fields = std::make_tuple(universal::impl::UniversalTryParseField(Params{}, from)...);
+      constexpr auto fieldsCount = boost::pfr::tuple_size_v<T>;
+      if([&]<auto... I>(std::index_sequence<I...>){
+        return (std::get<I>(fields) && ...);
+      }(std::make_index_sequence<fieldsCount>())) {
+        return [&]<auto... I>(std::index_sequence<I...>){
+          return T{*std::get<I>(fields)...};
+        }(std::make_index_sequence<fieldsCount>());
+      };
+      return std::nullopt;
+    }(Config{});
+  };
+};
+
+template <typename Format, typename T>
+constexpr inline
+std::enable_if_t<universal::impl::kIsEnumConfig<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>, T>
+Parse(Format&& from,
+    To<T>) {
+  const auto name = from.template As<std::string>();
+  const auto value = universal::impl::kEnumTable<std::remove_cvref_t<T>>.Find(name);
+  if(!value) {
+    throw std::runtime_error(fmt::format("Unknown enumerator: {0}", name));
+  };
+  return *value;
+};
+
+template <typename Format, typename T>
+constexpr inline
+std::enable_if_t<universal::impl::kIsEnumConfig<decltype(universal::kDeserialization<std::remove_cvref_t<T>>)>, std::optional<T>>
+TryParse(Format&& from,
+    To<T>) {
+  const auto name = TryParse(from, To<std::string>{});
+  if(!name) {
+    return std::nullopt;
+  };
+  return universal::impl::kEnumTable<std::remove_cvref_t<T>>.Find(*name);
 };
 
 } // namespace formats::parse
@@ -352,17 +1190,38 @@ namespace formats::serialize {
 
 template <typename T, typename Value>
 inline constexpr
-std::enable_if_t<!std::is_same_v<decltype(universal::kSerialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>, Value>
+std::enable_if_t<!std::is_same_v<decltype(universal::kSerialization<std::remove_cvref_t<T>>), const universal::impl::Disabled>
+    && !universal::impl::kIsEnumConfig<decltype(universal::kSerialization<std::remove_cvref_t<T>>)>, Value>
 Serialize(T&& obj,
     serialize::To<Value>) {
   using Config = std::remove_const_t<decltype(universal::kSerialization<std::remove_cvref_t<T>>)>;
   using Type = std::remove_cvref_t<T>;
-  return [&]<typename... Params>
-      (universal::SerializationConfig<Type, Params...>){
-    typename Value::Builder builder;
-    (universal::impl::UniversalSerializeField(Params{}, builder, obj), ...);
-    return builder.ExtractValue();
-  }(Config{});
+  universal::impl::DepthGuard<Type> guard;
+  if(guard.Exceeded()) {
+    throw std::runtime_error(universal::impl::DepthErrorMessage<Type>());
+  };
+  if constexpr(universal::impl::IsRecursive<Type>()) {
+    return universal::impl::IterativeSerialize<Value>(obj);
+  } else {
+    return [&]<typename... Params>
+        (universal::SerializationConfig<Type, Params...>){
+      typename Value::Builder builder;
+      (universal::impl::UniversalSerializeField(Params{}, builder, obj), ...);
+      return builder.ExtractValue();
+    }(Config{});
+  };
+};
+
+template <typename T, typename Value>
+inline constexpr
+std::enable_if_t<universal::impl::kIsEnumConfig<decltype(universal::kSerialization<std::remove_cvref_t<T>>)>, Value>
+Serialize(T&& obj,
+    serialize::To<Value>) {
+  const auto name = universal::impl::kEnumTable<std::remove_cvref_t<T>>.Name(obj);
+  if(name.empty()) {
+    throw std::runtime_error(fmt::format("Unknown enumerator value: {0}", static_cast<std::underlying_type_t<std::remove_cvref_t<T>>>(obj)));
+  };
+  return typename Value::Builder(name).ExtractValue();
 };
 
 } // namespace formats::serialize